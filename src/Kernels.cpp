@@ -0,0 +1,204 @@
+#include "headers/Kernels.hpp"
+#include "headers/BoardKernels.hpp"
+#include "headers/KernelVariants.hpp"
+
+#ifdef OTHELLO_X86_KERNELS
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace othello {
+
+    namespace kernels {
+
+        std::uint64_t legalMovesScalar(std::uint64_t player, std::uint64_t opponent) {
+            return ScalarKernels<8>::legalMoves(player, opponent);
+        }
+
+        std::uint64_t flipsScalar(int square, std::uint64_t player, std::uint64_t opponent) {
+            return ScalarKernels<8>::flips(square, player, opponent);
+        }
+
+        int popCountScalar(std::uint64_t bitboard) {
+            bitboard = bitboard - ((bitboard >> 1) & 0x5555555555555555ULL);
+            bitboard = (bitboard & 0x3333333333333333ULL) + ((bitboard >> 2) & 0x3333333333333333ULL);
+            bitboard = (bitboard + (bitboard >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+            return static_cast<int>((bitboard * 0x0101010101010101ULL) >> 56);
+        }
+
+    }
+
+    namespace {
+
+        const Kernels scalarKernels = {
+            kernels::legalMovesScalar, kernels::flipsScalar, kernels::popCountScalar
+        };
+
+#ifdef OTHELLO_X86_KERNELS
+        const Kernels sse2Kernels = {
+            kernels::legalMovesSSE2, kernels::flipsSSE2, kernels::popCountScalar
+        };
+
+        const Kernels avx2Kernels = {
+            kernels::legalMovesAVX2, kernels::flipsAVX2, kernels::popCountAVX2
+        };
+
+        // BMI2 only speeds up the flips, the moves are still generated with AVX2
+        const Kernels bmi2Kernels = {
+            kernels::legalMovesAVX2, kernels::flipsBMI2, kernels::popCountAVX2
+        };
+
+        struct CpuFeatures {
+            bool sse2 = false;
+            bool popcnt = false;
+            bool avx2 = false;
+            bool bmi2 = false;
+            // PEXT and PDEP are microcoded and very slow on AMD before Zen 3
+            bool fastBmi2 = false;
+        };
+
+        void cpuid(unsigned int leaf, unsigned int registers[4]) {
+#ifdef _MSC_VER
+            int result[4];
+            __cpuidex(result, static_cast<int>(leaf), 0);
+            for(int i = 0; i < 4; i++) {
+                registers[i] = static_cast<unsigned int>(result[i]);
+            }
+#else
+            __cpuid_count(leaf, 0, registers[0], registers[1], registers[2], registers[3]);
+#endif
+        }
+
+        // The OS has to save the YMM registers on context switches for AVX to be usable
+        bool isAvxStateEnabled() {
+#ifdef _MSC_VER
+            return (_xgetbv(0) & 0x6) == 0x6;
+#else
+            unsigned int eax, edx;
+            __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+            return (eax & 0x6) == 0x6;
+#endif
+        }
+
+        CpuFeatures detectCpuFeatures() {
+            CpuFeatures features;
+            unsigned int registers[4];
+
+            cpuid(0, registers);
+            unsigned int maxLeaf = registers[0];
+            // "AuthenticAMD", the vendor string is stored in ebx, edx, ecx
+            bool isAmd = registers[1] == 0x68747541 && registers[3] == 0x69746E65 && registers[2] == 0x444D4163;
+
+            cpuid(1, registers);
+            unsigned int family = (registers[0] >> 8) & 0xF;
+            if(family == 0xF) {
+                family += (registers[0] >> 20) & 0xFF;
+            }
+            features.sse2 = (registers[3] >> 26) & 1;
+            features.popcnt = (registers[2] >> 23) & 1;
+            bool osxsave = (registers[2] >> 27) & 1;
+            bool avx = (registers[2] >> 28) & 1;
+
+            if(maxLeaf >= 7 && osxsave && avx && isAvxStateEnabled()) {
+                cpuid(7, registers);
+                features.avx2 = ((registers[1] >> 5) & 1) && features.popcnt;
+                features.bmi2 = features.avx2 && ((registers[1] >> 8) & 1);
+                features.fastBmi2 = features.bmi2 && !(isAmd && family < 0x19);
+            }
+            return features;
+        }
+
+        const CpuFeatures cpuFeatures = detectCpuFeatures();
+#endif
+
+        const Kernels& getVariantKernels(KernelVariant variant) {
+            switch(variant) {
+#ifdef OTHELLO_X86_KERNELS
+                case KernelVariant::SSE2:
+                    return sse2Kernels;
+                case KernelVariant::AVX2:
+                    return avx2Kernels;
+                case KernelVariant::BMI2:
+                    return bmi2Kernels;
+#endif
+                default:
+                    return scalarKernels;
+            }
+        }
+
+        KernelVariant currentVariant = KernelVariant::Scalar;
+
+    }
+
+    const Kernels* activeKernels = &scalarKernels;
+
+    KernelVariant detectKernelVariant() {
+#ifdef OTHELLO_X86_KERNELS
+        if(cpuFeatures.fastBmi2) {
+            return KernelVariant::BMI2;
+        } else if(cpuFeatures.avx2) {
+            return KernelVariant::AVX2;
+        } else if(cpuFeatures.sse2) {
+            return KernelVariant::SSE2;
+        }
+#endif
+        return KernelVariant::Scalar;
+    }
+
+    bool isKernelVariantSupported(KernelVariant variant) {
+        switch(variant) {
+            case KernelVariant::Scalar:
+                return true;
+#ifdef OTHELLO_X86_KERNELS
+            case KernelVariant::SSE2:
+                return cpuFeatures.sse2;
+            case KernelVariant::AVX2:
+                return cpuFeatures.avx2;
+            case KernelVariant::BMI2:
+                return cpuFeatures.bmi2;
+#endif
+            default:
+                return false;
+        }
+    }
+
+    std::vector<KernelVariant> getSupportedKernelVariants() {
+        std::vector<KernelVariant> variants;
+        for(KernelVariant variant: {KernelVariant::Scalar, KernelVariant::SSE2, KernelVariant::AVX2, KernelVariant::BMI2}) {
+            if(isKernelVariantSupported(variant)) {
+                variants.push_back(variant);
+            }
+        }
+        return variants;
+    }
+
+    KernelVariant getKernelVariant() {
+        return currentVariant;
+    }
+
+    bool setKernelVariant(KernelVariant variant) {
+        if(!isKernelVariantSupported(variant)) {
+            return false;
+        }
+        currentVariant = variant;
+        activeKernels = &getVariantKernels(variant);
+        return true;
+    }
+
+    namespace {
+
+        // Selecting the best variant once, when the module gets loaded
+        struct KernelSelector {
+            KernelSelector() {
+                setKernelVariant(detectKernelVariant());
+            }
+        };
+
+        const KernelSelector kernelSelector;
+
+    }
+
+}
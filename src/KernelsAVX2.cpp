@@ -0,0 +1,82 @@
+#include "headers/KernelVariants.hpp"
+
+#include <immintrin.h>
+
+namespace othello {
+namespace kernels {
+
+    /*
+    All four lines are handled at once, one per lane, with the shift amounts 1, 8, 7 and 9.
+    Only the opposite directions need a second pass
+    */
+    static inline __m256i getShifts() {
+        return _mm256_set_epi64x(9, 7, 8, 1);
+    }
+
+    static inline __m256i getMasks(std::uint64_t opponent) {
+        __m256i masks = _mm256_set_epi64x(
+            0x007E7E7E7E7E7E00LL, 0x007E7E7E7E7E7E00LL, 0x00FFFFFFFFFFFF00LL, 0x7E7E7E7E7E7E7E7ELL
+        );
+        return _mm256_and_si256(masks, _mm256_set1_epi64x(static_cast<long long>(opponent)));
+    }
+
+    static inline __m256i shiftFillLeft(__m256i pieces, __m256i mask, __m256i shifts) {
+        __m256i line = _mm256_and_si256(mask, _mm256_sllv_epi64(pieces, shifts));
+        for(int i = 0; i < 5; i++) {
+            line = _mm256_or_si256(line, _mm256_and_si256(mask, _mm256_sllv_epi64(line, shifts)));
+        }
+        return line;
+    }
+
+    static inline __m256i shiftFillRight(__m256i pieces, __m256i mask, __m256i shifts) {
+        __m256i line = _mm256_and_si256(mask, _mm256_srlv_epi64(pieces, shifts));
+        for(int i = 0; i < 5; i++) {
+            line = _mm256_or_si256(line, _mm256_and_si256(mask, _mm256_srlv_epi64(line, shifts)));
+        }
+        return line;
+    }
+
+    static inline std::uint64_t reduceOr(__m256i lanes) {
+        __m128i half = _mm_or_si128(_mm256_castsi256_si128(lanes), _mm256_extracti128_si256(lanes, 1));
+        half = _mm_or_si128(half, _mm_unpackhi_epi64(half, half));
+        return static_cast<std::uint64_t>(_mm_cvtsi128_si64(half));
+    }
+
+    std::uint64_t legalMovesAVX2(std::uint64_t player, std::uint64_t opponent) {
+        __m256i shifts = getShifts();
+        __m256i masks = getMasks(opponent);
+        __m256i players = _mm256_set1_epi64x(static_cast<long long>(player));
+
+        __m256i moves = _mm256_or_si256(
+            _mm256_sllv_epi64(shiftFillLeft(players, masks, shifts), shifts),
+            _mm256_srlv_epi64(shiftFillRight(players, masks, shifts), shifts)
+        );
+
+        return reduceOr(moves) & ~(player | opponent);
+    }
+
+    std::uint64_t flipsAVX2(int square, std::uint64_t player, std::uint64_t opponent) {
+        __m256i shifts = getShifts();
+        __m256i masks = getMasks(opponent);
+        __m256i players = _mm256_set1_epi64x(static_cast<long long>(player));
+        __m256i piece = _mm256_set1_epi64x(static_cast<long long>(1ULL << square));
+        __m256i zero = _mm256_setzero_si256();
+
+        // A line is only flipped when the square right after it holds one of the player's pieces
+        __m256i left = shiftFillLeft(piece, masks, shifts);
+        __m256i leftOutflank = _mm256_and_si256(_mm256_sllv_epi64(left, shifts), players);
+        left = _mm256_andnot_si256(_mm256_cmpeq_epi64(leftOutflank, zero), left);
+
+        __m256i right = shiftFillRight(piece, masks, shifts);
+        __m256i rightOutflank = _mm256_and_si256(_mm256_srlv_epi64(right, shifts), players);
+        right = _mm256_andnot_si256(_mm256_cmpeq_epi64(rightOutflank, zero), right);
+
+        return reduceOr(_mm256_or_si256(left, right));
+    }
+
+    int popCountAVX2(std::uint64_t bitboard) {
+        return static_cast<int>(_mm_popcnt_u64(bitboard));
+    }
+
+}
+}
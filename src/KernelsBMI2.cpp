@@ -0,0 +1,112 @@
+#include "headers/KernelVariants.hpp"
+
+#include <immintrin.h>
+
+namespace othello {
+namespace kernels {
+
+    /*
+    The four lines going through every square are gathered into a byte with PEXT, the flips
+    of that line are looked up and then scattered back onto the board with PDEP.
+    The tables are built at compile time, this unit is compiled for BMI2 and must not run
+    any code before the CPU has been checked.
+    */
+    struct FlipTables {
+        // The row, the column and both diagonals of every square
+        std::uint64_t lineMasks[64][4];
+        // The index of the square inside each of its lines
+        std::uint8_t linePositions[64][4];
+        // The squares right after the opponent pieces next to a position, in both directions
+        std::uint8_t outflanks[8][256];
+        // The squares between a position and its outflanking squares
+        std::uint8_t flipped[8][256];
+    };
+
+    static constexpr FlipTables buildFlipTables() {
+        FlipTables tables{};
+
+        const int deltas[4][2] = {{1, 0}, {0, 1}, {1, 1}, {1, -1}};
+        for(int square = 0; square < 64; square++) {
+            int x = square % 8;
+            int y = square / 8;
+            for(int line = 0; line < 4; line++) {
+                int deltaX = deltas[line][0];
+                int deltaY = deltas[line][1];
+                // Walking back to the start of the line, then collecting all of its squares
+                int startX = x;
+                int startY = y;
+                while(startX-deltaX >= 0 && startY-deltaY >= 0 && startY-deltaY < 8) {
+                    startX -= deltaX;
+                    startY -= deltaY;
+                }
+                std::uint64_t mask = 0;
+                for(int lineX = startX, lineY = startY; lineX < 8 && lineY >= 0 && lineY < 8; lineX += deltaX, lineY += deltaY) {
+                    mask |= 1ULL << (lineY*8 + lineX);
+                }
+                int position = 0;
+                for(int below = 0; below < square; below++) {
+                    if(mask & (1ULL << below)) {
+                        position++;
+                    }
+                }
+                tables.lineMasks[square][line] = mask;
+                tables.linePositions[square][line] = static_cast<std::uint8_t>(position);
+            }
+        }
+
+        for(int position = 0; position < 8; position++) {
+            for(int pattern = 0; pattern < 256; pattern++) {
+                int outflank = 0;
+                int up = position + 1;
+                while(up < 8 && (pattern & (1 << up))) {
+                    up++;
+                }
+                if(up > position + 1 && up < 8) {
+                    outflank |= 1 << up;
+                }
+                int down = position - 1;
+                while(down >= 0 && (pattern & (1 << down))) {
+                    down--;
+                }
+                if(down < position - 1 && down >= 0) {
+                    outflank |= 1 << down;
+                }
+                tables.outflanks[position][pattern] = static_cast<std::uint8_t>(outflank);
+
+                // For this table the pattern is read as the outflanking squares
+                int flipped = 0;
+                for(int end = 0; end < 8; end++) {
+                    if(!(pattern & (1 << end))) {
+                        continue;
+                    }
+                    int from = end > position ? position + 1 : end + 1;
+                    int to = end > position ? end : position;
+                    for(int bit = from; bit < to; bit++) {
+                        flipped |= 1 << bit;
+                    }
+                }
+                tables.flipped[position][pattern] = static_cast<std::uint8_t>(flipped);
+            }
+        }
+
+        return tables;
+    }
+
+    static constexpr FlipTables flipTables = buildFlipTables();
+
+    std::uint64_t flipsBMI2(int square, std::uint64_t player, std::uint64_t opponent) {
+        std::uint64_t flipped = 0;
+        for(int line = 0; line < 4; line++) {
+            std::uint64_t mask = flipTables.lineMasks[square][line];
+            int position = flipTables.linePositions[square][line];
+
+            std::uint64_t opponentLine = _pext_u64(opponent, mask);
+            std::uint64_t playerLine = _pext_u64(player, mask);
+            std::uint64_t outflank = flipTables.outflanks[position][opponentLine] & playerLine;
+            flipped |= _pdep_u64(flipTables.flipped[position][outflank], mask);
+        }
+        return flipped;
+    }
+
+}
+}
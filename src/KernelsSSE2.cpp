@@ -0,0 +1,76 @@
+#include "headers/KernelVariants.hpp"
+
+#include <emmintrin.h>
+
+namespace othello {
+namespace kernels {
+
+    /*
+    SSE2 has no per lane shift counts, so a register holds the two opposite directions of one
+    line instead: the low lane is shifted to the left and the high lane to the right
+    */
+    template<int Shift>
+    static inline __m128i shiftPair(__m128i pieces) {
+        __m128d left = _mm_castsi128_pd(_mm_slli_epi64(pieces, Shift));
+        __m128d right = _mm_castsi128_pd(_mm_srli_epi64(pieces, Shift));
+        return _mm_castpd_si128(_mm_move_sd(right, left));
+    }
+
+    template<int Shift>
+    static inline __m128i shiftFillPair(__m128i pieces, __m128i mask) {
+        __m128i line = _mm_and_si128(mask, shiftPair<Shift>(pieces));
+        for(int i = 0; i < 5; i++) {
+            line = _mm_or_si128(line, _mm_and_si128(mask, shiftPair<Shift>(line)));
+        }
+        return line;
+    }
+
+    template<int Shift>
+    static inline __m128i flipsPair(__m128i piece, __m128i player, __m128i mask) {
+        __m128i line = shiftFillPair<Shift>(piece, mask);
+        __m128i outflank = _mm_and_si128(shiftPair<Shift>(line), player);
+
+        // There's no 64 bit compare in SSE2, a lane is zero when both of its halves are
+        __m128i zero = _mm_cmpeq_epi32(outflank, _mm_setzero_si128());
+        zero = _mm_and_si128(zero, _mm_shuffle_epi32(zero, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_andnot_si128(zero, line);
+    }
+
+    static inline std::uint64_t reduceOr(__m128i lanes) {
+        lanes = _mm_or_si128(lanes, _mm_unpackhi_epi64(lanes, lanes));
+        return static_cast<std::uint64_t>(_mm_cvtsi128_si64(lanes));
+    }
+
+    std::uint64_t legalMovesSSE2(std::uint64_t player, std::uint64_t opponent) {
+        __m128i players = _mm_set1_epi64x(static_cast<long long>(player));
+        __m128i opponents = _mm_set1_epi64x(static_cast<long long>(opponent));
+        __m128i horizontal = _mm_and_si128(opponents, _mm_set1_epi64x(0x7E7E7E7E7E7E7E7ELL));
+        __m128i vertical = _mm_and_si128(opponents, _mm_set1_epi64x(0x00FFFFFFFFFFFF00LL));
+        __m128i diagonal = _mm_and_si128(opponents, _mm_set1_epi64x(0x007E7E7E7E7E7E00LL));
+
+        __m128i moves = shiftPair<1>(shiftFillPair<1>(players, horizontal));
+        moves = _mm_or_si128(moves, shiftPair<8>(shiftFillPair<8>(players, vertical)));
+        moves = _mm_or_si128(moves, shiftPair<7>(shiftFillPair<7>(players, diagonal)));
+        moves = _mm_or_si128(moves, shiftPair<9>(shiftFillPair<9>(players, diagonal)));
+
+        return reduceOr(moves) & ~(player | opponent);
+    }
+
+    std::uint64_t flipsSSE2(int square, std::uint64_t player, std::uint64_t opponent) {
+        __m128i piece = _mm_set1_epi64x(static_cast<long long>(1ULL << square));
+        __m128i players = _mm_set1_epi64x(static_cast<long long>(player));
+        __m128i opponents = _mm_set1_epi64x(static_cast<long long>(opponent));
+        __m128i horizontal = _mm_and_si128(opponents, _mm_set1_epi64x(0x7E7E7E7E7E7E7E7ELL));
+        __m128i vertical = _mm_and_si128(opponents, _mm_set1_epi64x(0x00FFFFFFFFFFFF00LL));
+        __m128i diagonal = _mm_and_si128(opponents, _mm_set1_epi64x(0x007E7E7E7E7E7E00LL));
+
+        __m128i flipped = flipsPair<1>(piece, players, horizontal);
+        flipped = _mm_or_si128(flipped, flipsPair<8>(piece, players, vertical));
+        flipped = _mm_or_si128(flipped, flipsPair<7>(piece, players, diagonal));
+        flipped = _mm_or_si128(flipped, flipsPair<9>(piece, players, diagonal));
+
+        return reduceOr(flipped);
+    }
+
+}
+}
@@ -2,40 +2,31 @@
 
 namespace othello {
 
-    Othello::Othello() {
+    template<int Size>
+    BasicOthello<Size>::BasicOthello() {
+        m_state.turn = Piece::Black;
         initializeBoard();
-        m_turn = Piece::Black;
     }
 
-    Othello::Othello(const Othello& othello) {
-        for(int y = 0; y < BOARD_SIZE; y++) {
-            for(int x = 0; x < BOARD_SIZE; x++) {
-                Position position{x, y};
-                setPiece(position, othello.getPiece(position));
-            }
-        }
-
-        m_turn = othello.getTurn();
+    template<int Size>
+    BasicOthello<Size>::BasicOthello(const BasicOthello& othello) {
+        m_state = othello.m_state;
+        m_history = othello.m_history;
     }
 
-    void Othello::initializeBoard() {
-            // setting all squares to zero
-            for(int y = 0; y < BOARD_SIZE; y++) {
-                for(int x = 0; x < BOARD_SIZE; x++) {
-                    Position position{x, y};
-                    setPiece(position, Piece::Empty);
-                }
-            }
+    template<int Size>
+    void BasicOthello<Size>::initializeBoard() {
+            // setting the initial square, every other one is empty
+            int center = BOARD_SIZE / 2;
+            m_state.whitePieces = getSquareBit(Position{center-1, center-1}) | getSquareBit(Position{center, center});
+            m_state.blackPieces = getSquareBit(Position{center, center-1}) | getSquareBit(Position{center-1, center});
 
-            // setting the initial square
-            setPiece(Position{3, 3}, Piece::White);
-            setPiece(Position{4, 4}, Piece::White);
-
-            setPiece(Position{4, 3}, Piece::Black);
-            setPiece(Position{3, 4}, Piece::Black);
+            m_history.clear();
+            refreshState();
     }
 
-    bool Othello::isValidPosition(Position position) const {
+    template<int Size>
+    bool BasicOthello<Size>::isValidPosition(Position position) const {
         if(position.x >= BOARD_SIZE || position.y >= BOARD_SIZE
         || position.x < 0 || position.y < 0) {
             return false;
@@ -44,168 +35,223 @@ namespace othello {
         }
     }
 
-    Piece Othello::getPiece(Position position) const {
-        return m_board[position.y][position.x];
+    template<int Size>
+    typename BasicOthello<Size>::Bitboard BasicOthello<Size>::getSquareBit(Position position) {
+        return Bitboard(1) << (position.y*BOARD_SIZE + position.x);
     }
 
-    Piece Othello::getTurn() const {
-        return m_turn;
+    template<int Size>
+    typename BasicOthello<Size>::Bitboard BasicOthello<Size>::getPlayerBitboard() const {
+        if(m_state.turn == Piece::Black) {
+            return m_state.blackPieces;
+        } else {
+            return m_state.whitePieces;
+        }
     }
 
-    std::vector<std::vector<Piece>> Othello::getBoard() const {
+    template<int Size>
+    typename BasicOthello<Size>::Bitboard BasicOthello<Size>::getOpponentBitboard() const {
+        if(m_state.turn == Piece::Black) {
+            return m_state.whitePieces;
+        } else {
+            return m_state.blackPieces;
+        }
+    }
+
+    template<int Size>
+    typename BasicOthello<Size>::Bitboard BasicOthello<Size>::getLegalMoveBitboard() const {
+        return m_state.legalMoves;
+    }
+
+    template<int Size>
+    void BasicOthello<Size>::refreshState() {
+        m_state.blackPieceCount = BoardKernels<Size>::popCount(m_state.blackPieces);
+        m_state.whitePieceCount = BoardKernels<Size>::popCount(m_state.whitePieces);
+        m_state.legalMoves = BoardKernels<Size>::legalMoves(getPlayerBitboard(), getOpponentBitboard());
+        m_state.passed = false;
+
+        // if both players have no legal moves left, then it's over
+        m_state.ended = !m_state.legalMoves
+            && !BoardKernels<Size>::legalMoves(getOpponentBitboard(), getPlayerBitboard());
+    }
+
+    template<int Size>
+    Piece BasicOthello<Size>::getPiece(Position position) const {
+        Bitboard square = getSquareBit(position);
+        if(m_state.blackPieces & square) {
+            return Piece::Black;
+        } else if(m_state.whitePieces & square) {
+            return Piece::White;
+        } else {
+            return Piece::Empty;
+        }
+    }
+
+    template<int Size>
+    Piece BasicOthello<Size>::getTurn() const {
+        return m_state.turn;
+    }
+
+    template<int Size>
+    std::vector<std::vector<Piece>> BasicOthello<Size>::getBoard() const {
         std::vector<std::vector<Piece>> board = std::vector<std::vector<Piece>>(BOARD_SIZE);
         for(int i = 0; i < BOARD_SIZE; i++) {
             std::vector<Piece> row = std::vector<Piece>(BOARD_SIZE);
             for(int j = 0; j < BOARD_SIZE; j++) {
-                row[j] = m_board[i][j];
+                row[j] = getPiece(Position{j, i});
             }
             board[i] = row;
         }
         return board;
     }
 
-    void Othello::setTurn(Piece turn) {
-        m_turn = turn;
-    }
-
-    void Othello::setPiece(Position position, Piece piece) {
-        m_board[position.y][position.x] = piece;
+    template<int Size>
+    void BasicOthello<Size>::setTurn(Piece turn) {
+        m_state.turn = turn;
+        m_history.clear();
+        refreshState();
     }
 
-    void Othello::makeTurnOpposite() {
-        if(m_turn == Piece::Black) {
-            m_turn = Piece::White;
-        } else {
-            m_turn = Piece::Black;
+    template<int Size>
+    void BasicOthello<Size>::setPiece(Position position, Piece piece) {
+        Bitboard square = getSquareBit(position);
+        m_state.blackPieces &= ~square;
+        m_state.whitePieces &= ~square;
+        if(piece == Piece::Black) {
+            m_state.blackPieces |= square;
+        } else if(piece == Piece::White) {
+            m_state.whitePieces |= square;
         }
+        m_history.clear();
+        refreshState();
     }
 
-    bool Othello::isLegalMove(Position position) const {
-        Piece currentPiece = m_turn;
-        Piece oppositePiece;
-        if(currentPiece == Piece::Black) {
-            oppositePiece = Piece::White;
+    template<int Size>
+    void BasicOthello<Size>::makeTurnOpposite() {
+        if(m_state.turn == Piece::Black) {
+            m_state.turn = Piece::White;
         } else {
-            oppositePiece = Piece::Black;
+            m_state.turn = Piece::Black;
         }
+        m_history.clear();
+        refreshState();
+    }
 
+    template<int Size>
+    bool BasicOthello<Size>::isLegalMove(Position position) const {
         // The square should be a valid position
         if(!isValidPosition(position)) {
             return false;
         }
 
-        // There shoudn't be a piece in the current square
-        if(getPiece(position) != Piece::Empty) {
-            return false;
-        }
-
-        for(Position direction: directions) {
-
-            int deltaX = direction.x;
-            int deltaY = direction.y;
-
-            Position nextPosition = Position{position.x+deltaX, position.y+deltaY};
-            if(!(isValidPosition(nextPosition) && getPiece(nextPosition) == oppositePiece)) {
-                continue;
-            }
-
-            while(true) {
-                nextPosition = Position{nextPosition.x+deltaX, nextPosition.y+deltaY};
-                if(!isValidPosition(nextPosition)) {
-                    break;
-                }
-                Piece nextPiece = getPiece(nextPosition);
-                if(nextPiece == Piece::Empty) {
-                    break;
-                } else if(nextPiece == currentPiece) {
-                    return true;
-                } else {
-                    continue;
-                }
-            }
-        }
-
-        // If non are applicable, then it means the current sqaure is not a legal move
-        return false;
+        return (getLegalMoveBitboard() & getSquareBit(position)) != 0;
     }
 
-    std::vector<Position> Othello::getLegalMoves() const {
+    template<int Size>
+    std::vector<Position> BasicOthello<Size>::getLegalMoves() const {
+        Bitboard moves = getLegalMoveBitboard();
+
         std::vector<Position> legalPositions = std::vector<Position>();
+        legalPositions.reserve(BoardKernels<Size>::popCount(moves));
+        // Moves are listed column by column, skipping the columns that have none
         for(int x = 0; x < BOARD_SIZE; x++) {
-            for(int y = 0; y < BOARD_SIZE; y++) {
-                if(isLegalMove(Position{x, y})) {
+            Bitboard column = moves & (BoardTraits<Size>::COLUMN_MASK << x);
+            for(int y = 0; column; y++) {
+                Bitboard square = getSquareBit(Position{x, y});
+                if(column & square) {
                     Position legalPosition = {x, y};
                     legalPositions.push_back(legalPosition);
+                    column &= ~square;
                 }
             }
         }
         return legalPositions;
-    } 
+    }
+
+    template<int Size>
+    int BasicOthello<Size>::getLegalMoveCount() const {
+        return BoardKernels<Size>::popCount(getLegalMoveBitboard());
+    }
 
-    void Othello::placePiece(Position position) {
-        Piece currentPiece = m_turn;
-        Piece oppositePiece;
-        if(currentPiece == Piece::Black) {
-            oppositePiece = Piece::White;
+    template<int Size>
+    void BasicOthello<Size>::applyPlacement(Position position) {
+        Bitboard square = getSquareBit(position);
+        int squareIndex = position.y*BOARD_SIZE + position.x;
+        Bitboard flipped = BoardKernels<Size>::flips(squareIndex, getPlayerBitboard(), getOpponentBitboard());
+        Bitboard changed = flipped | square;
+
+        // Counting from the bits that really changed, the square may already hold a piece
+        // since moves aren't checked for legality
+        int gainedCount = BoardKernels<Size>::popCount(changed & ~getPlayerBitboard());
+        int lostCount = BoardKernels<Size>::popCount(changed & getOpponentBitboard());
+
+        if(m_state.turn == Piece::Black) {
+            m_state.blackPieces |= changed;
+            m_state.whitePieces &= ~changed;
+            m_state.blackPieceCount += gainedCount;
+            m_state.whitePieceCount -= lostCount;
         } else {
-            oppositePiece = Piece::Black;
+            m_state.whitePieces |= changed;
+            m_state.blackPieces &= ~changed;
+            m_state.whitePieceCount += gainedCount;
+            m_state.blackPieceCount -= lostCount;
         }
+    }
 
-        std::vector<Position> piecesToChange;
+    template<int Size>
+    void BasicOthello<Size>::placePiece(Position position) {
+        applyPlacement(position);
+        m_history.clear();
+        refreshState();
+    }
 
-        for(Position direction: directions) {
+    template<int Size>
+    void BasicOthello<Size>::move(Position position) {
+        m_history.push_back(HistoryEntry{m_state, position});
 
-            int deltaX = direction.x;
-            int deltaY = direction.y;
+        applyPlacement(position);
+        m_state.turn = m_state.turn == Piece::Black ? Piece::White : Piece::Black;
+        m_state.legalMoves = BoardKernels<Size>::legalMoves(getPlayerBitboard(), getOpponentBitboard());
+        m_state.passed = false;
+        m_state.ended = false;
 
-            Position nextPosition = Position{position.x+deltaX, position.y+deltaY};
-            if(!(isValidPosition(nextPosition) && getPiece(nextPosition) == oppositePiece)) {
-                continue;
-            }
-
-            // while(isValidPosition(nextPosition))
-            for(int i = 1; ; i++) {
-                nextPosition = Position{nextPosition.x+deltaX, nextPosition.y+deltaY};
-                if(!isValidPosition(nextPosition)) {
-                    break;
-                }
-                Piece nextPiece = getPiece(nextPosition);
-                if(nextPiece == Piece::Empty) {
-                    break;
-                } else if(nextPiece == currentPiece) {
-                    for(int j = 1; j <= i; j++) {
-                        Position pieceToChange = Position();
-                        pieceToChange.x = position.x + j*deltaX;
-                        pieceToChange.y = position.y + j*deltaY;
-
-                        piecesToChange.push_back(pieceToChange);
-                    }
-                    break;
-                } else {
-                    continue;
-                }
-            }
+        // If the next player has no legal moves but the other player does, then the game 
+        // still continues and it would be the other player's turn
+        if(!m_state.legalMoves) {
+            m_state.turn = m_state.turn == Piece::Black ? Piece::White : Piece::Black;
+            m_state.legalMoves = BoardKernels<Size>::legalMoves(getPlayerBitboard(), getOpponentBitboard());
+            m_state.passed = true;
+            m_state.ended = !m_state.legalMoves;
         }
+    }
 
-        for(Position position: piecesToChange) {
-            setPiece(position, currentPiece);
+    template<int Size>
+    bool BasicOthello<Size>::undo() {
+        if(m_history.empty()) {
+            return false;
         }
+        m_state = m_history.back().state;
+        m_history.pop_back();
+        return true;
+    }
 
-        setPiece(position, currentPiece);
+    template<int Size>
+    bool BasicOthello<Size>::hasPassed() const {
+        return m_state.passed;
     }
 
-    void Othello::move(Position position) {
-        placePiece(position);
-        makeTurnOpposite();
-        // If the next player has no legal moves but the other player does, then the game 
-        // still continues and it would be the other player's turn
-        if(getLegalMoves().size() == 0) {
-            makeTurnOpposite();
+    template<int Size>
+    std::vector<Position> BasicOthello<Size>::getMoveHistory() const {
+        std::vector<Position> positions;
+        positions.reserve(m_history.size());
+        for(const HistoryEntry& entry: m_history) {
+            positions.push_back(entry.position);
         }
+        return positions;
     }
 
-
-    void Othello::printBoard(bool showLegalMoves) const {
+    template<int Size>
+    void BasicOthello<Size>::printBoard(bool showLegalMoves) const {
         for(int y = 0; y < BOARD_SIZE; y++) {
             for(int x = 0; x < BOARD_SIZE; x++) {
                 Position position = Position{x, y};
@@ -224,82 +270,36 @@ namespace othello {
         }
     }
 
-    int Othello::getEmptySpotCount() const {
-        int count = 0;
-        for(int y = 0; y < BOARD_SIZE; y++) {
-            for(int x = 0; x < BOARD_SIZE; x++) {
-                Position position = Position{x, y};
-                if(getPiece(position) == Piece::Empty) {
-                    count++;
-                }
-            }
-        }
-        return count;
+    template<int Size>
+    int BasicOthello<Size>::getEmptySpotCount() const {
+        return BOARD_SIZE*BOARD_SIZE - getTotalPieceCount();
     }
 
-    bool Othello::isEnd() {
-
-
-
-        // if both players have no legal moves left, then it's over
-        if(this->getLegalMoves().size() == 0) {
-            // checking whether the second player has any moves left or not
-            makeTurnOpposite();
-            if(this->getLegalMoves().size() == 0) {
-                return true;
-            }
-            // returning it to the initial turn
-            makeTurnOpposite();
-        }
-        return false;
+    template<int Size>
+    bool BasicOthello<Size>::isEnd() const {
+        return m_state.ended;
     }
 
-    int Othello::getTotalPieceCount() const {
-        // basically calculating pieces
-        int whitePieceCount = 0;
-        for(int y = 0; y < BOARD_SIZE; y++) {
-            for(int x = 0; x < BOARD_SIZE; x++) {
-                Position position = Position{x, y};
-                if(getPiece(position) != Piece::Empty) {
-                    whitePieceCount++;
-                }
-            }
-        }
-        return whitePieceCount;
+    template<int Size>
+    int BasicOthello<Size>::getTotalPieceCount() const {
+        return m_state.blackPieceCount + m_state.whitePieceCount;
     }
 
-    int Othello::getWhitePieceCount() const {
-        // basically calculating all white's pieces
-        int whitePieceCount = 0;
-        for(int y = 0; y < BOARD_SIZE; y++) {
-            for(int x = 0; x < BOARD_SIZE; x++) {
-                Position position = Position{x, y};
-                if(getPiece(position) == Piece::White) {
-                    whitePieceCount++;
-                }
-            }
-        }
-        return whitePieceCount;
+    template<int Size>
+    int BasicOthello<Size>::getWhitePieceCount() const {
+        return m_state.whitePieceCount;
     }
 
-    int Othello::getBlackPieceCount() const {
-        // basically calculating all black's pieces
-        int blackPieceCount = 0;
-        for(int y = 0; y < BOARD_SIZE; y++) {
-            for(int x = 0; x < BOARD_SIZE; x++) {
-                Position position = Position{x, y};
-                if(getPiece(position) == Piece::Black) {
-                    blackPieceCount++;
-                }
-            }
-        }
-        return blackPieceCount;
+    template<int Size>
+    int BasicOthello<Size>::getBlackPieceCount() const {
+        return m_state.blackPieceCount;
     }
 
-    int Othello::getFinalScoreOfWinner() const {
+    template<int Size>
+    int BasicOthello<Size>::getFinalScoreOfWinner() const {
         int whitePieceCount = getWhitePieceCount();
         int blackPieceCount = getBlackPieceCount();
-        int emptyTiles = 64 - whitePieceCount - blackPieceCount;
+        int emptyTiles = BOARD_SIZE*BOARD_SIZE - whitePieceCount - blackPieceCount;
 
         if(whitePieceCount > blackPieceCount) {
             return whitePieceCount + emptyTiles;
@@ -310,7 +310,8 @@ namespace othello {
         }
     }
 
-    Piece Othello::getWinner() const {
+    template<int Size>
+    Piece BasicOthello<Size>::getWinner() const {
         int blackScore = getBlackPieceCount();
         int whiteScore = getWhitePieceCount();
         if(whiteScore > blackScore) {
@@ -322,4 +323,8 @@ namespace othello {
         }
     }
 
+    template class BasicOthello<6>;
+    template class BasicOthello<8>;
+    template class BasicOthello<10>;
+
 }
\ No newline at end of file
@@ -2,21 +2,22 @@
 
 namespace othello {
 
-    int OthelloSolver::evaluate(int prevLegalMoves) {
-        if(isEnd()) {
+    template<int Size>
+    int BasicOthelloSolver<Size>::evaluate(int prevLegalMoves) {
+        if(this->isEnd()) {
             // The 
-            int whiteBlackDiff = getWhitePieceCount() - getBlackPieceCount();
+            int whiteBlackDiff = this->getWhitePieceCount() - this->getBlackPieceCount();
             if(whiteBlackDiff > 0) {
-                int whiteScore = whiteBlackDiff + getEmptySpotCount();
+                int whiteScore = whiteBlackDiff + this->getEmptySpotCount();
                 return MINIMAX_INFINITY + whiteScore;
             } else if(whiteBlackDiff < 0) {
-                int blackScore = -whiteBlackDiff + getEmptySpotCount();
+                int blackScore = -whiteBlackDiff + this->getEmptySpotCount();
                 return -MINIMAX_INFINITY - blackScore;
             } else {
                 return 0;
             }
         } else {
-            int currentLegalMoves = getLegalMoves().size();
+            int currentLegalMoves = this->getLegalMoveCount();
 
             // Mobility ratio is the ratio of the the current available moves and the other
             // player's previous move. If the other player had no moves then it's considered zero
@@ -30,7 +31,7 @@ namespace othello {
                 // if the other player had no moves then that means the position is really good
                 mobilityRatio = 10000*currentLegalMoves;
                 mobilityRatioInverse = 0;
-            } else if(getTurn() == Piece::White) {
+            } else if(this->getTurn() == Piece::White) {
                 if(prevLegalMoves == 0) {
                     mobilityRatio = 10000*currentLegalMoves;
                     mobilityRatioInverse = 0;
@@ -48,64 +49,69 @@ namespace othello {
                 }
             }
 
-            int result = getWhitePieceCount() - getBlackPieceCount() + mobilityRatio - mobilityRatioInverse;
+            int result = this->getWhitePieceCount() - this->getBlackPieceCount() + mobilityRatio - mobilityRatioInverse;
 
-            if(getPiece(Position{0, 0}) == Piece::White) {
+            if(this->getPiece(Position{0, 0}) == Piece::White) {
                 result += CORNER_VALUE;
-            } else if(getPiece(Position{0, 0}) == Piece::Black) {
+            } else if(this->getPiece(Position{0, 0}) == Piece::Black) {
                 result -= CORNER_VALUE;
             }
 
-            if(getPiece(Position{0, 7}) == Piece::White) {
+            if(this->getPiece(Position{0, Size-1}) == Piece::White) {
                 result += CORNER_VALUE;
-            } else if(getPiece(Position{0, 7}) == Piece::Black) {
+            } else if(this->getPiece(Position{0, Size-1}) == Piece::Black) {
                 result -= CORNER_VALUE;
             }
 
-            if(getPiece(Position{7, 0}) == Piece::White) {
+            if(this->getPiece(Position{Size-1, 0}) == Piece::White) {
                 result += CORNER_VALUE;
-            } else if(getPiece(Position{7, 0}) == Piece::Black) {
+            } else if(this->getPiece(Position{Size-1, 0}) == Piece::Black) {
                 result -= CORNER_VALUE;
             }
 
-            if(getPiece(Position{7, 7}) == Piece::White) {
+            if(this->getPiece(Position{Size-1, Size-1}) == Piece::White) {
                 result += CORNER_VALUE;
-            } else if(getPiece(Position{7, 7}) == Piece::Black) {
+            } else if(this->getPiece(Position{Size-1, Size-1}) == Piece::Black) {
                 result -= CORNER_VALUE;
             }
             return result;
         }
     }
 
-    Node OthelloSolver::miniMax(OthelloSolver board, int depth, int alpha, int beta, int prevLegalMoves) {
-        if(depth == 0 || board.isEnd()) {
+    template<int Size>
+    Node BasicOthelloSolver<Size>::miniMax(BasicOthelloSolver board, int depth, int alpha, int beta, int prevLegalMoves) {
+        return board.search(depth, alpha, beta, prevLegalMoves);
+    }
+
+    template<int Size>
+    Node BasicOthelloSolver<Size>::search(int depth, int alpha, int beta, int prevLegalMoves) {
+        if(depth == 0 || this->isEnd()) {
             std::vector<Position> positionHierarchy = std::vector<Position>();
-            int score = board.evaluate(prevLegalMoves);
+            int score = evaluate(prevLegalMoves);
             Node lastNode{positionHierarchy, score};
             return lastNode;
         } else {
-            std::vector<Position> legalPositions = board.getLegalMoves();
+            std::vector<Position> legalPositions = this->getLegalMoves();
             bool firstNode = true;
             Node extremeNode{std::vector<Position>(), 0};
 
             for(Position position: legalPositions) {
-                OthelloSolver othelloCopy = board;
-                othelloCopy.placePiece(position);
-                othelloCopy.makeTurnOpposite();
-                if(othelloCopy.getLegalMoves().size() == 0) {
+                this->move(position);
+                if(this->hasPassed()) {
                     prevLegalMoves = 0;
-                    othelloCopy.makeTurnOpposite();
                 } else {
                     prevLegalMoves = legalPositions.size();
                 }
-                Node childNode = miniMax(othelloCopy, depth-1, alpha, beta, prevLegalMoves);
+                Node childNode = search(depth-1, alpha, beta, prevLegalMoves);
+                this->undo();
+
                 if(firstNode) {
                     childNode.positionHierarchy.push_back(position);
                     extremeNode = childNode;
 
                     firstNode = false;
                 } else {
-                    if(board.getTurn() == Piece::Black) {
+                    if(this->getTurn() == Piece::Black) {
                         if(childNode.score < extremeNode.score) {
                             childNode.positionHierarchy.push_back(position);
                             extremeNode = childNode;
@@ -128,21 +134,111 @@ namespace othello {
         }
     }
 
-    Node OthelloSolver::solve(int depth, int lastMoves) {
-        if(getEmptySpotCount() > lastMoves) {
+    template<int Size>
+    Node BasicOthelloSolver<Size>::solve(int depth, int lastMoves) {
+        int emptySpots = this->getEmptySpotCount();
+        if(emptySpots <= lastMoves) {
+            depth = -1;
+        }
+        if(m_sharedCache == nullptr) {
             return miniMax(*this, depth, -MINIMAX_INFINITY, MINIMAX_INFINITY);
-        } else {
-            return miniMax(*this, -1, -MINIMAX_INFINITY, MINIMAX_INFINITY);
         }
+
+        // Searching as deep as there are empty spots already reaches the end of the game
+        int cacheDepth = depth;
+        if(depth < 0 || depth >= emptySpots || depth >= SharedCache::FULL_DEPTH) {
+            cacheDepth = SharedCache::FULL_DEPTH;
+        }
+        std::uint64_t key;
+        std::uint64_t check;
+        getCacheKeys(key, check);
+
+        CachedResult cachedResult;
+        if(m_sharedCache->probe(key, check, cachedResult) && cachedResult.depth >= cacheDepth) {
+            Node cachedNode{std::vector<Position>(), cachedResult.score};
+            // The entry may be corrupted or come from another board, so it's a miss unless
+            // it could be the result of searching this position: every square on the board,
+            // a legal first move, and no line only where the search doesn't make a move
+            bool isValidLine = cachedResult.lineLength > 0 || depth == 0 || this->isEnd();
+            // The hierarchy starts with the last move
+            for(int i = cachedResult.lineLength - 1; i >= 0 && isValidLine; i--) {
+                int square = cachedResult.line[i];
+                if(square >= Size*Size) {
+                    isValidLine = false;
+                } else {
+                    cachedNode.positionHierarchy.push_back(Position{square % Size, square / Size});
+                }
+            }
+            if(isValidLine && cachedResult.lineLength > 0 && !this->isLegalMove(cachedNode.positionHierarchy.back())) {
+                isValidLine = false;
+            }
+            if(isValidLine) {
+                return cachedNode;
+            }
+        }
+
+        Node node = miniMax(*this, depth, -MINIMAX_INFINITY, MINIMAX_INFINITY);
+
+        cachedResult.score = node.score;
+        cachedResult.depth = cacheDepth;
+        cachedResult.lineLength = 0;
+        for(int i = static_cast<int>(node.positionHierarchy.size()) - 1; i >= 0 && cachedResult.lineLength < CachedResult::MAX_LINE_LENGTH; i--) {
+            Position position = node.positionHierarchy[i];
+            cachedResult.line[cachedResult.lineLength++] = static_cast<std::uint8_t>(position.y*Size + position.x);
+        }
+        m_sharedCache->store(key, check, cachedResult);
+        return node;
     }
 
-    void OthelloSolver::makeSmartMove(int depth, int lastMoves) {
+    template<int Size>
+    void BasicOthelloSolver<Size>::setSharedCache(SharedCache* sharedCache) {
+        m_sharedCache = sharedCache;
+    }
+
+    template<int Size>
+    SharedCache* BasicOthelloSolver<Size>::getSharedCache() const {
+        return m_sharedCache;
+    }
+
+    namespace {
+
+        // The finalizer of splitmix64, every input bit affects every output bit
+        std::uint64_t mixBits(std::uint64_t value) {
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+            return value ^ (value >> 31);
+        }
+
+        std::uint64_t hashBitboard(std::uint64_t bitboard, std::uint64_t seed) {
+            return mixBits(bitboard ^ seed);
+        }
+
+        std::uint64_t hashBitboard(WideBitboard bitboard, std::uint64_t seed) {
+            return mixBits(mixBits(bitboard.low ^ seed) ^ bitboard.high);
+        }
+
+    }
+
+    template<int Size>
+    void BasicOthelloSolver<Size>::getCacheKeys(std::uint64_t& key, std::uint64_t& check) const {
+        // Boards of different sizes and turns can share a cache without mixing up positions
+        std::uint64_t base = static_cast<std::uint64_t>(Size)*2 + (this->getTurn() == Piece::White ? 1 : 0);
+        key = hashBitboard(this->getPlayerBitboard(), hashBitboard(this->getOpponentBitboard(), base));
+        check = hashBitboard(this->getOpponentBitboard(), hashBitboard(this->getPlayerBitboard(), ~base));
+    }
+
+    template<int Size>
+    void BasicOthelloSolver<Size>::makeSmartMove(int depth, int lastMoves) {
         Node currentNode = solve(depth, lastMoves);
 
         // It may be null because the game has ended and it's attempting to use a non-existant node
         if(currentNode.positionHierarchy.size() != 0) {
             Position nextPosition = currentNode.positionHierarchy[currentNode.positionHierarchy.size()-1];
-            move(nextPosition);
+            this->move(nextPosition);
         }
     }
+
+    template class BasicOthelloSolver<6>;
+    template class BasicOthelloSolver<8>;
+    template class BasicOthelloSolver<10>;
 }
\ No newline at end of file
@@ -1,43 +1,84 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include <stdexcept>
+
+#include "headers/Kernels.hpp"
 #include "headers/Othello.hpp"
 #include "headers/OthelloSolver.hpp"
+#include "headers/SharedCache.hpp"
 
 using namespace othello;
 
 namespace py = pybind11;
 
+/*
+Binds a board size under the given class names, the methods are the same for every size
+*/
+template<int Size>
+void bindOthello(py::module& m, const char* othelloName, const char* solverName) {
+    typedef BasicOthello<Size> SizedOthello;
+    typedef BasicOthelloSolver<Size> SizedOthelloSolver;
+
+    py::class_<SizedOthello> othello(m, othelloName);
+    py::class_<SizedOthelloSolver> othelloSolver(m, solverName, othello);
+
+    othello.def(py::init<>())
+        .def_property_readonly_static("BOARD_SIZE", [](py::object) { return Size; })
+        .def("initialize_board", &SizedOthello::initializeBoard)
+        .def("get_turn", &SizedOthello::getTurn)
+        .def("get_piece", &SizedOthello::getPiece)
+        .def("get_board", &SizedOthello::getBoard)
+        .def("set_turn", &SizedOthello::setTurn)
+        .def("set_piece", &SizedOthello::setPiece)
+        .def("is_valid_position", &SizedOthello::isValidPosition)
+        .def("make_turn_opposite", &SizedOthello::makeTurnOpposite)
+        .def("is_legal_move", &SizedOthello::isLegalMove)
+        .def("get_legal_moves", &SizedOthello::getLegalMoves)
+        .def("get_legal_move_count", &SizedOthello::getLegalMoveCount)
+        .def("place_piece", &SizedOthello::placePiece)
+        .def("move", &SizedOthello::move)
+        .def("undo", &SizedOthello::undo)
+        .def("has_passed", &SizedOthello::hasPassed)
+        .def("get_move_history", &SizedOthello::getMoveHistory)
+        .def("print_board", &SizedOthello::printBoard)
+        .def("get_empty_spot_count", &SizedOthello::getEmptySpotCount)
+        .def("get_total_piece_count", &SizedOthello::getTotalPieceCount)
+        .def("get_white_piece_count", &SizedOthello::getWhitePieceCount)
+        .def("get_black_piece_count", &SizedOthello::getBlackPieceCount)
+        .def("is_end", &SizedOthello::isEnd)
+        .def("get_final_score_of_winner", &SizedOthello::getFinalScoreOfWinner)
+        .def("get_winner", &SizedOthello::getWinner);
+
+    othelloSolver.def(py::init<>())
+        .def("evaluate", &SizedOthelloSolver::evaluate)
+        .def("mini_max", &SizedOthelloSolver::miniMax)
+        .def("solve", &SizedOthelloSolver::solve)
+        .def("make_smart_move", &SizedOthelloSolver::makeSmartMove)
+        .def("set_shared_cache", &SizedOthelloSolver::setSharedCache, py::keep_alive<1, 2>())
+        .def("get_shared_cache", &SizedOthelloSolver::getSharedCache, py::return_value_policy::reference);
+}
+
 
 PYBIND11_MODULE(PyOthello, m) {
 
-    py::class_<Othello> othello(m, "Othello");
     py::class_<Position> position(m, "Position");
     py::enum_<Piece> piece(m, "Piece");
-    py::class_<OthelloSolver> othelloSolver(m, "OthelloSolver", othello);
     py::class_<Node> node(m, "Node");
+    py::enum_<KernelVariant> kernelVariant(m, "KernelVariant");
+    py::class_<SharedCache> sharedCache(m, "SharedCache");
 
-    othello.def(py::init<>())
-        .def("initialize_board", &Othello::initializeBoard)
-        .def("get_turn", &Othello::getTurn)
-        .def("get_piece", &Othello::getPiece)
-        .def("get_board", &Othello::getBoard)
-        .def("set_turn", &Othello::setTurn)
-        .def("set_piece", &Othello::setPiece)
-        .def("is_valid_position", &Othello::isValidPosition)
-        .def("make_turn_opposite", &Othello::makeTurnOpposite)
-        .def("is_legal_move", &Othello::isLegalMove)
-        .def("get_legal_moves", &Othello::getLegalMoves)
-        .def("place_piece", &Othello::placePiece)
-        .def("move", &Othello::move)
-        .def("print_board", &Othello::printBoard)
-        .def("get_empty_spot_count", &Othello::getEmptySpotCount)
-        .def("get_total_piece_count", &Othello::getTotalPieceCount)
-        .def("get_white_piece_count", &Othello::getWhitePieceCount)
-        .def("get_black_piece_count", &Othello::getBlackPieceCount)
-        .def("is_end", &Othello::isEnd)
-        .def("get_final_score_of_winner", &Othello::getFinalScoreOfWinner)
-        .def("get_winner", &Othello::getWinner);
+    // Defined before the solvers so their methods can take and return it
+    sharedCache.def(py::init<const std::string&, int>())
+        .def("clear", &SharedCache::clear)
+        .def("reset", &SharedCache::reset)
+        .def("get_slot_count", &SharedCache::getSlotCount)
+        .def("get_name", &SharedCache::getName)
+        .def_static("remove", &SharedCache::remove);
+
+    bindOthello<8>(m, "Othello", "OthelloSolver");
+    bindOthello<6>(m, "Othello6", "OthelloSolver6");
+    bindOthello<10>(m, "Othello10", "OthelloSolver10");
 
     position.def(py::init<>())
         .def_readwrite("x", &Position::x)
@@ -48,13 +89,21 @@ PYBIND11_MODULE(PyOthello, m) {
         .value("Black", Piece::Black)
         .value("White", Piece::White);
 
-    othelloSolver.def(py::init<>())
-        .def("evaluate", &OthelloSolver::evaluate)
-        .def("mini_max", &OthelloSolver::miniMax)
-        .def("solve", &OthelloSolver::solve)
-        .def("make_smart_move", &OthelloSolver::makeSmartMove);
-
     node.def(py::init<>())
         .def_readwrite("x", &Node::positionHierarchy)
         .def_readwrite("y", &Node::score);
+
+    kernelVariant.value("Scalar", KernelVariant::Scalar)
+        .value("SSE2", KernelVariant::SSE2)
+        .value("AVX2", KernelVariant::AVX2)
+        .value("BMI2", KernelVariant::BMI2);
+
+    m.def("detect_kernel_variant", &detectKernelVariant)
+        .def("get_supported_kernel_variants", &getSupportedKernelVariants)
+        .def("get_kernel_variant", &getKernelVariant)
+        .def("set_kernel_variant", [](KernelVariant variant) {
+            if(!setKernelVariant(variant)) {
+                throw std::invalid_argument("The kernel variant isn't supported by this CPU");
+            }
+        });
 }
\ No newline at end of file
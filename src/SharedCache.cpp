@@ -0,0 +1,296 @@
+#include "headers/SharedCache.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace othello {
+
+    namespace {
+
+        // Has to go up whenever the slot layout or the way results are encoded in it changes,
+        // caches left behind by older versions are then refused instead of misread
+        const std::uint64_t CACHE_VERSION = 1;
+
+        // Marks a cache that's been fully set up by the process that created it, "PyOthel"
+        // followed by the version
+        const std::uint64_t CACHE_MAGIC = 0x50794F7468656C00ULL | CACHE_VERSION;
+
+        // Set in the data of slots that hold a result, so an empty slot is never a hit
+        const std::uint64_t VALID_BIT = 1ULL << 63;
+
+        // How long to wait for another process that's still creating the cache
+        const int CREATION_WAIT_MILLISECONDS = 1000;
+
+        void waitBriefly() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+#ifdef _WIN32
+        std::string getMappingName(const std::string& name) {
+            std::string baseName = name;
+            if(!baseName.empty() && baseName[0] == '/') {
+                baseName = baseName.substr(1);
+            }
+            return "Local\\PyOthello_" + baseName;
+        }
+#else
+        // POSIX shared memory names start with a slash
+        std::string getObjectName(const std::string& name) {
+            if(!name.empty() && name[0] == '/') {
+                return name;
+            } else {
+                return "/" + name;
+            }
+        }
+#endif
+
+    }
+
+    SharedCache::SharedCache(const std::string& name, int slotCount)
+        : m_name(name), m_memory(nullptr), m_size(0), m_header(nullptr), m_slots(nullptr), m_slotCount(0) {
+        if(slotCount <= 0) {
+            throw std::invalid_argument("The cache needs at least one slot");
+        }
+        std::size_t requestedSize = sizeof(Header) + static_cast<std::size_t>(slotCount)*sizeof(Slot);
+        bool created;
+
+#ifdef _WIN32
+        std::uint64_t mappingSize = requestedSize;
+        m_mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+            static_cast<DWORD>(mappingSize >> 32), static_cast<DWORD>(mappingSize), getMappingName(name).c_str());
+        if(m_mapping == nullptr) {
+            throw std::runtime_error("Couldn't open the shared cache " + name);
+        }
+        created = GetLastError() != ERROR_ALREADY_EXISTS;
+
+        m_memory = MapViewOfFile(m_mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+        if(m_memory == nullptr) {
+            CloseHandle(m_mapping);
+            throw std::runtime_error("Couldn't map the shared cache " + name);
+        }
+        MEMORY_BASIC_INFORMATION information;
+        VirtualQuery(m_memory, &information, sizeof(information));
+        m_size = information.RegionSize;
+#else
+        std::string objectName = getObjectName(name);
+        int descriptor = shm_open(objectName.c_str(), O_RDWR | O_CREAT | O_EXCL, 0666);
+        created = descriptor != -1;
+        if(!created && errno == EEXIST) {
+            descriptor = shm_open(objectName.c_str(), O_RDWR, 0666);
+        }
+        if(descriptor == -1) {
+            throw std::runtime_error("Couldn't open the shared cache " + name + ": " + std::strerror(errno));
+        }
+
+        if(created) {
+            if(ftruncate(descriptor, static_cast<off_t>(requestedSize)) == -1) {
+                int error = errno;
+                close(descriptor);
+                shm_unlink(objectName.c_str());
+                throw std::runtime_error("Couldn't size the shared cache " + name + ": " + std::strerror(error));
+            }
+#ifdef __linux__
+            // ftruncate alone reserves nothing on tmpfs, running out of it later would raise
+            // SIGBUS on the first write to a page, so the whole cache is allocated up front
+            int error = posix_fallocate(descriptor, 0, static_cast<off_t>(requestedSize));
+            if(error != 0) {
+                close(descriptor);
+                shm_unlink(objectName.c_str());
+                throw std::runtime_error("Couldn't allocate the shared cache " + name + ": " + std::strerror(error));
+            }
+#endif
+            m_size = requestedSize;
+        } else {
+            // The process creating it may not have sized it yet
+            struct stat status;
+            for(int i = 0; i < CREATION_WAIT_MILLISECONDS; i++) {
+                if(fstat(descriptor, &status) == 0 && status.st_size >= static_cast<off_t>(sizeof(Header))) {
+                    m_size = static_cast<std::size_t>(status.st_size);
+                    break;
+                }
+                waitBriefly();
+            }
+            if(m_size == 0) {
+                close(descriptor);
+                throw std::runtime_error("The shared cache " + name + " was never set up");
+            }
+        }
+
+        void* memory = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+        close(descriptor);
+        if(memory == MAP_FAILED) {
+            throw std::runtime_error("Couldn't map the shared cache " + name + ": " + std::strerror(errno));
+        }
+        m_memory = memory;
+#endif
+
+        // New shared memory is zero filled, which is an empty slot
+        m_header = static_cast<Header*>(m_memory);
+        if(created) {
+            m_header->slotCount = static_cast<std::uint64_t>(slotCount);
+            m_header->magic.store(CACHE_MAGIC, std::memory_order_release);
+        } else {
+            for(int i = 0; i < CREATION_WAIT_MILLISECONDS; i++) {
+                if(m_header->magic.load(std::memory_order_acquire) == CACHE_MAGIC) {
+                    break;
+                }
+                waitBriefly();
+            }
+        }
+
+        m_slotCount = m_header->slotCount;
+        if(m_header->magic.load(std::memory_order_acquire) != CACHE_MAGIC
+        || m_slotCount == 0 || sizeof(Header) + m_slotCount*sizeof(Slot) > m_size) {
+            unmap();
+            throw std::runtime_error("The shared memory " + name + " isn't a valid cache for this version");
+        }
+        m_slots = reinterpret_cast<Slot*>(static_cast<char*>(m_memory) + sizeof(Header));
+    }
+
+    SharedCache::~SharedCache() {
+        unmap();
+    }
+
+    void SharedCache::unmap() {
+#ifdef _WIN32
+        UnmapViewOfFile(m_memory);
+        CloseHandle(m_mapping);
+#else
+        munmap(m_memory, m_size);
+#endif
+    }
+
+    SharedCache::Slot& SharedCache::getSlot(std::uint64_t key) const {
+        return m_slots[key % m_slotCount];
+    }
+
+    bool SharedCache::probe(std::uint64_t key, std::uint64_t check, CachedResult& result) const {
+        Slot& slot = getSlot(key);
+
+        std::uint64_t version = slot.version.load(std::memory_order_acquire);
+        if(version & 1) {
+            return false;
+        }
+        std::uint64_t slotKey = slot.key.load(std::memory_order_relaxed);
+        std::uint64_t slotCheck = slot.check.load(std::memory_order_relaxed);
+        std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+        std::uint64_t line[CachedResult::MAX_LINE_LENGTH / 8];
+        for(int i = 0; i < CachedResult::MAX_LINE_LENGTH / 8; i++) {
+            line[i] = slot.line[i].load(std::memory_order_relaxed);
+        }
+        // If a writer got in while reading, what was read may be torn
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(slot.version.load(std::memory_order_relaxed) != version) {
+            return false;
+        }
+
+        if(!(data & VALID_BIT) || slotKey != key || slotCheck != check) {
+            return false;
+        }
+        result.score = static_cast<std::int32_t>(static_cast<std::uint32_t>(data));
+        result.depth = static_cast<int>((data >> 32) & 0xFF);
+        result.lineLength = static_cast<int>((data >> 40) & 0xFF);
+        // The memory may have been written by another version, nothing in it can be trusted
+        if(result.lineLength > CachedResult::MAX_LINE_LENGTH) {
+            return false;
+        }
+        for(int i = 0; i < result.lineLength; i++) {
+            result.line[i] = static_cast<std::uint8_t>(line[i / 8] >> (8*(i % 8)));
+        }
+        return true;
+    }
+
+    void SharedCache::store(std::uint64_t key, std::uint64_t check, const CachedResult& result) {
+        Slot& slot = getSlot(key);
+
+        std::uint64_t version = slot.version.load(std::memory_order_relaxed);
+        if(version & 1) {
+            return;
+        }
+        std::uint64_t slotData = slot.data.load(std::memory_order_relaxed);
+        if((slotData & VALID_BIT) && slot.key.load(std::memory_order_relaxed) == key
+        && slot.check.load(std::memory_order_relaxed) == check
+        && static_cast<int>((slotData >> 32) & 0xFF) > result.depth) {
+            return;
+        }
+        // Taking the slot, if another process was faster then its result is kept instead
+        if(!slot.version.compare_exchange_strong(version, version + 1, std::memory_order_acquire)) {
+            return;
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+
+        int lineLength = result.lineLength < CachedResult::MAX_LINE_LENGTH ? result.lineLength : CachedResult::MAX_LINE_LENGTH;
+        std::uint64_t line[CachedResult::MAX_LINE_LENGTH / 8] = {};
+        for(int i = 0; i < lineLength; i++) {
+            line[i / 8] |= static_cast<std::uint64_t>(result.line[i]) << (8*(i % 8));
+        }
+        std::uint64_t data = VALID_BIT | static_cast<std::uint32_t>(result.score)
+            | static_cast<std::uint64_t>(result.depth & 0xFF) << 32
+            | static_cast<std::uint64_t>(lineLength) << 40;
+
+        slot.key.store(key, std::memory_order_relaxed);
+        slot.check.store(check, std::memory_order_relaxed);
+        slot.data.store(data, std::memory_order_relaxed);
+        for(int i = 0; i < CachedResult::MAX_LINE_LENGTH / 8; i++) {
+            slot.line[i].store(line[i], std::memory_order_relaxed);
+        }
+
+        slot.version.store(version + 2, std::memory_order_release);
+    }
+
+    void SharedCache::clear() {
+        for(std::uint64_t i = 0; i < m_slotCount; i++) {
+            Slot& slot = m_slots[i];
+            std::uint64_t version = slot.version.load(std::memory_order_relaxed);
+            if((version & 1) || !slot.version.compare_exchange_strong(version, version + 1, std::memory_order_acquire)) {
+                continue;
+            }
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.data.store(0, std::memory_order_relaxed);
+            slot.version.store(version + 2, std::memory_order_release);
+        }
+    }
+
+    void SharedCache::reset() {
+        for(std::uint64_t i = 0; i < m_slotCount; i++) {
+            Slot& slot = m_slots[i];
+            // Taking the slot whether it's busy or not, the version still only ever grows
+            std::uint64_t version = slot.version.load(std::memory_order_relaxed) | 1;
+            slot.version.store(version, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slot.data.store(0, std::memory_order_relaxed);
+            slot.version.store(version + 1, std::memory_order_release);
+        }
+    }
+
+    int SharedCache::getSlotCount() const {
+        return static_cast<int>(m_slotCount);
+    }
+
+    std::string SharedCache::getName() const {
+        return m_name;
+    }
+
+    bool SharedCache::remove(const std::string& name) {
+#ifdef _WIN32
+        // A named mapping is gone once nothing has it open anymore
+        (void)name;
+        return false;
+#else
+        return shm_unlink(getObjectName(name).c_str()) == 0;
+#endif
+    }
+
+}
@@ -0,0 +1,220 @@
+#include <cstdint>
+#include <type_traits>
+
+#include "Kernels.hpp"
+
+#pragma once
+
+namespace othello {
+
+    /*
+    A 128 bit bitboard for boards that have more than 64 squares
+    */
+    struct WideBitboard {
+        std::uint64_t low;
+        std::uint64_t high;
+
+        constexpr WideBitboard(std::uint64_t low = 0, std::uint64_t high = 0) : low(low), high(high) {}
+
+        constexpr WideBitboard operator&(WideBitboard other) const {
+            return WideBitboard(low & other.low, high & other.high);
+        }
+
+        constexpr WideBitboard operator|(WideBitboard other) const {
+            return WideBitboard(low | other.low, high | other.high);
+        }
+
+        constexpr WideBitboard operator^(WideBitboard other) const {
+            return WideBitboard(low ^ other.low, high ^ other.high);
+        }
+
+        constexpr WideBitboard operator~() const {
+            return WideBitboard(~low, ~high);
+        }
+
+        constexpr WideBitboard operator<<(int shift) const {
+            if(shift == 0) {
+                return *this;
+            } else if(shift >= 64) {
+                return WideBitboard(0, low << (shift - 64));
+            } else {
+                return WideBitboard(low << shift, (high << shift) | (low >> (64 - shift)));
+            }
+        }
+
+        constexpr WideBitboard operator>>(int shift) const {
+            if(shift == 0) {
+                return *this;
+            } else if(shift >= 64) {
+                return WideBitboard(high >> (shift - 64), 0);
+            } else {
+                return WideBitboard((low >> shift) | (high << (64 - shift)), high >> shift);
+            }
+        }
+
+        WideBitboard& operator&=(WideBitboard other) {
+            return *this = *this & other;
+        }
+
+        WideBitboard& operator|=(WideBitboard other) {
+            return *this = *this | other;
+        }
+
+        WideBitboard& operator^=(WideBitboard other) {
+            return *this = *this ^ other;
+        }
+
+        constexpr bool operator==(WideBitboard other) const {
+            return low == other.low && high == other.high;
+        }
+
+        constexpr bool operator!=(WideBitboard other) const {
+            return !(*this == other);
+        }
+
+        constexpr explicit operator bool() const {
+            return (low | high) != 0;
+        }
+    };
+
+    /*
+    Everything that depends on the size of the board. Bit y*Size+x is the square at Position{x, y}
+    */
+    template<int Size>
+    struct BoardTraits {
+        static_assert(Size >= 4 && Size % 2 == 0, "The board needs an even size of at least 4");
+        static_assert(Size*Size <= 128, "The board can have at most 128 squares");
+
+        typedef typename std::conditional<Size*Size <= 64, std::uint64_t, WideBitboard>::type Bitboard;
+
+        static constexpr Bitboard getRectangleMask(int minX, int maxX, int minY, int maxY) {
+            Bitboard mask = 0;
+            for(int y = minY; y <= maxY; y++) {
+                for(int x = minX; x <= maxX; x++) {
+                    mask = mask | (Bitboard(1) << (y*Size + x));
+                }
+            }
+            return mask;
+        }
+
+        // Every square of the board, the bits past the last square are never set
+        static constexpr Bitboard BOARD_MASK = getRectangleMask(0, Size-1, 0, Size-1);
+
+        // Opponent pieces a line can run through without wrapping around an edge, for
+        // horizontal, vertical and diagonal directions respectively
+        static constexpr Bitboard HORIZONTAL_MASK = getRectangleMask(1, Size-2, 0, Size-1);
+        static constexpr Bitboard VERTICAL_MASK = getRectangleMask(0, Size-1, 1, Size-2);
+        static constexpr Bitboard DIAGONAL_MASK = getRectangleMask(1, Size-2, 1, Size-2);
+
+        // The leftmost column, shifted by x it becomes any other column
+        static constexpr Bitboard COLUMN_MASK = getRectangleMask(0, 0, 0, Size-1);
+    };
+
+    /*
+    The portable kernels, fully unrolled for one board size
+    */
+    template<int Size>
+    struct ScalarKernels {
+        typedef BoardTraits<Size> Traits;
+        typedef typename Traits::Bitboard Bitboard;
+
+        // Shifting to the left for positive amounts and to the right for negative ones
+        template<int Shift>
+        static Bitboard shift(Bitboard pieces) {
+            if constexpr(Shift > 0) {
+                return pieces << Shift;
+            } else {
+                return pieces >> -Shift;
+            }
+        }
+
+        // Collecting the opponent pieces that are connected to the given pieces in one
+        // direction, a line can contain at most Size-2 of them
+        template<int Shift>
+        static Bitboard shiftFill(Bitboard pieces, Bitboard mask) {
+            Bitboard line = mask & shift<Shift>(pieces);
+            for(int i = 0; i < Size-3; i++) {
+                line |= mask & shift<Shift>(line);
+            }
+            return line;
+        }
+
+        template<int Shift>
+        static Bitboard movesInDirection(Bitboard player, Bitboard mask) {
+            return shift<Shift>(shiftFill<Shift>(player, mask));
+        }
+
+        // The line only gets flipped if it ends with one of the player's pieces
+        template<int Shift>
+        static Bitboard flipsInDirection(Bitboard piece, Bitboard player, Bitboard mask) {
+            Bitboard line = shiftFill<Shift>(piece, mask);
+            if(shift<Shift>(line) & player) {
+                return line;
+            } else {
+                return 0;
+            }
+        }
+
+        static Bitboard legalMoves(Bitboard player, Bitboard opponent) {
+            Bitboard horizontal = opponent & Traits::HORIZONTAL_MASK;
+            Bitboard vertical = opponent & Traits::VERTICAL_MASK;
+            Bitboard diagonal = opponent & Traits::DIAGONAL_MASK;
+
+            Bitboard moves = movesInDirection<1>(player, horizontal) | movesInDirection<-1>(player, horizontal)
+                | movesInDirection<Size>(player, vertical) | movesInDirection<-Size>(player, vertical)
+                | movesInDirection<Size-1>(player, diagonal) | movesInDirection<1-Size>(player, diagonal)
+                | movesInDirection<Size+1>(player, diagonal) | movesInDirection<-Size-1>(player, diagonal);
+
+            return moves & ~(player | opponent) & Traits::BOARD_MASK;
+        }
+
+        static Bitboard flips(int square, Bitboard player, Bitboard opponent) {
+            Bitboard piece = Bitboard(1) << square;
+            Bitboard horizontal = opponent & Traits::HORIZONTAL_MASK;
+            Bitboard vertical = opponent & Traits::VERTICAL_MASK;
+            Bitboard diagonal = opponent & Traits::DIAGONAL_MASK;
+
+            return flipsInDirection<1>(piece, player, horizontal) | flipsInDirection<-1>(piece, player, horizontal)
+                | flipsInDirection<Size>(piece, player, vertical) | flipsInDirection<-Size>(piece, player, vertical)
+                | flipsInDirection<Size-1>(piece, player, diagonal) | flipsInDirection<1-Size>(piece, player, diagonal)
+                | flipsInDirection<Size+1>(piece, player, diagonal) | flipsInDirection<-Size-1>(piece, player, diagonal);
+        }
+    };
+
+    /*
+    The kernels a board of the given size uses. The population count is shared by every size
+    */
+    template<int Size>
+    struct BoardKernels : ScalarKernels<Size> {
+        typedef typename ScalarKernels<Size>::Bitboard Bitboard;
+
+        static int popCount(std::uint64_t bitboard) {
+            return activeKernels->popCount(bitboard);
+        }
+
+        static int popCount(WideBitboard bitboard) {
+            return activeKernels->popCount(bitboard.low) + activeKernels->popCount(bitboard.high);
+        }
+    };
+
+    /*
+    The standard board goes through the kernels picked for the CPU at runtime
+    */
+    template<>
+    struct BoardKernels<8> {
+        typedef othello::Bitboard Bitboard;
+
+        static Bitboard legalMoves(Bitboard player, Bitboard opponent) {
+            return activeKernels->legalMoves(player, opponent);
+        }
+
+        static Bitboard flips(int square, Bitboard player, Bitboard opponent) {
+            return activeKernels->flips(square, player, opponent);
+        }
+
+        static int popCount(Bitboard bitboard) {
+            return activeKernels->popCount(bitboard);
+        }
+    };
+
+}
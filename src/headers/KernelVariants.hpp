@@ -0,0 +1,29 @@
+#include <cstdint>
+
+#pragma once
+
+/*
+Entry points of the per instruction set kernels. The SIMD ones live in their own translation
+units that are compiled with extra target flags, so this header must stay free of inline
+code: anything inlined there could be emitted with instructions the host doesn't have.
+*/
+namespace othello {
+namespace kernels {
+
+    std::uint64_t legalMovesScalar(std::uint64_t player, std::uint64_t opponent);
+    std::uint64_t flipsScalar(int square, std::uint64_t player, std::uint64_t opponent);
+    int popCountScalar(std::uint64_t bitboard);
+
+#ifdef OTHELLO_X86_KERNELS
+    std::uint64_t legalMovesSSE2(std::uint64_t player, std::uint64_t opponent);
+    std::uint64_t flipsSSE2(int square, std::uint64_t player, std::uint64_t opponent);
+
+    std::uint64_t legalMovesAVX2(std::uint64_t player, std::uint64_t opponent);
+    std::uint64_t flipsAVX2(int square, std::uint64_t player, std::uint64_t opponent);
+    int popCountAVX2(std::uint64_t bitboard);
+
+    std::uint64_t flipsBMI2(int square, std::uint64_t player, std::uint64_t opponent);
+#endif
+
+}
+}
@@ -0,0 +1,72 @@
+#include <cstdint>
+#include <vector>
+
+#pragma once
+
+namespace othello {
+
+    /*
+    A board is stored as two bitboards, one per color. Bit y*8+x is set when the square
+    at Position{x, y} holds a piece of that color.
+    */
+    typedef std::uint64_t Bitboard;
+
+    enum KernelVariant {
+        Scalar,
+        SSE2,
+        AVX2,
+        BMI2
+    };
+
+    /*
+    The hot board kernels. Every variant computes exactly the same results, they only
+    differ in the instruction set they were compiled for.
+    */
+    struct Kernels {
+        /*
+        Get every empty square where the player can place a piece
+        */
+        Bitboard (*legalMoves)(Bitboard player, Bitboard opponent);
+
+        /*
+        Get the opponent pieces that get flipped when the player places a piece on square
+        */
+        Bitboard (*flips)(int square, Bitboard player, Bitboard opponent);
+
+        /*
+        Get the amount of set bits
+        */
+        int (*popCount)(Bitboard bitboard);
+    };
+
+    /*
+    The kernels currently in use. Chosen by CPU feature detection when the library is loaded
+    */
+    extern const Kernels* activeKernels;
+
+    /*
+    Get the best variant the current CPU supports
+    */
+    KernelVariant detectKernelVariant();
+
+    /*
+    Check whether the variant was compiled in and the current CPU can run it
+    */
+    bool isKernelVariantSupported(KernelVariant variant);
+
+    /*
+    Get all variants that can run on the current CPU
+    */
+    std::vector<KernelVariant> getSupportedKernelVariants();
+
+    /*
+    Get the variant currently in use
+    */
+    KernelVariant getKernelVariant();
+
+    /*
+    Force a variant. Returns false and keeps the current one if the variant isn't supported
+    */
+    bool setKernelVariant(KernelVariant variant);
+
+}
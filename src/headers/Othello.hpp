@@ -2,6 +2,8 @@
 #include <vector>
 #include <array>
 
+#include "BoardKernels.hpp"
+
 #pragma once
 
 namespace othello {
@@ -17,16 +19,22 @@ namespace othello {
         int y;
     };
 
-    class Othello {
+    /*
+    An Othello game on a Size x Size board, the standard game is Othello, an alias of BasicOthello<8>
+    */
+    template<int Size>
+    class BasicOthello {
 
         
         public:
 
-            static const int BOARD_SIZE = 8;
+            static const int BOARD_SIZE = Size;
+
+            typedef typename BoardKernels<Size>::Bitboard Bitboard;
 
-            Othello();
+            BasicOthello();
 
-            Othello(const Othello& othello);
+            BasicOthello(const BasicOthello& othello);
 
             /*
             Sets the board to its initial form
@@ -49,12 +57,12 @@ namespace othello {
             std::vector<std::vector<Piece>> getBoard() const;
 
             /*
-            Sets the game's turn
+            Sets the game's turn and clears the move history
             */
             void setTurn(Piece turn);
 
             /*
-            Sets a piece into the given position
+            Sets a piece into the given position and clears the move history
             */
             void setPiece(Position position, Piece piece);
 
@@ -64,7 +72,7 @@ namespace othello {
             bool isValidPosition(Position position) const;
 
             /*
-            Make the turn the opposite of what it already is
+            Make the turn the opposite of what it already is and clear the move history
             */
             void makeTurnOpposite();
 
@@ -79,7 +87,12 @@ namespace othello {
             std::vector<Position> getLegalMoves() const;
 
             /*
-            Place a piece
+            Get the amount of legal moves, cheaper than getting the moves themselves
+            */
+            int getLegalMoveCount() const;
+
+            /*
+            Place a piece and clear the move history
             */
             void placePiece(Position position);
 
@@ -88,6 +101,23 @@ namespace othello {
             */
             void move(Position position);
 
+            /*
+            Take back the last move made with move. Editing the board in any other way clears
+            the moves that can be taken back. Returns false if there's no move to take back
+            */
+            bool undo();
+
+            /*
+            Whether the last move left the other player without legal moves, so the same
+            player had to move again
+            */
+            bool hasPassed() const;
+
+            /*
+            Get every position played with move, starting from the first one
+            */
+            std::vector<Position> getMoveHistory() const;
+
             /*
             Print the board and optionally show legal moves
             */
@@ -117,7 +147,7 @@ namespace othello {
             Determine if the game has ended or not. If it has ended then the return value
             is true, else it's false
             */
-            bool isEnd();
+            bool isEnd() const;
 
             /*
             Get the final score of winner, if zero then it's a draw.
@@ -137,10 +167,69 @@ namespace othello {
                 Position{0, -1}, Position{-1, 1}, Position{-1, 0}, Position{-1, -1} 
             };
 
+        protected:
+            /*
+            Get the bit of a position on a bitboard
+            */
+            static Bitboard getSquareBit(Position position);
+
+            /*
+            Get the pieces of the player whose turn it is, as a bitboard
+            */
+            Bitboard getPlayerBitboard() const;
+
+            /*
+            Get the pieces of the player who's waiting for their turn, as a bitboard
+            */
+            Bitboard getOpponentBitboard() const;
+
+            /*
+            Get every square the current player can move to, as a bitboard
+            */
+            Bitboard getLegalMoveBitboard() const;
+
         private:
-            Piece m_board[BOARD_SIZE][BOARD_SIZE];
+            /*
+            Everything a move changes. It's kept up to date on every change, and saved as a whole
+            before each move so undoing is only a copy
+            */
+            struct State {
+                Bitboard blackPieces;
+                Bitboard whitePieces;
+                Piece turn;
+
+                // The legal moves of the player whose turn it is
+                Bitboard legalMoves;
+                int blackPieceCount;
+                int whitePieceCount;
+
+                bool passed;
+                bool ended;
+            };
 
-            Piece m_turn;
+            struct HistoryEntry {
+                State state;
+                Position position;
+            };
+
+            /*
+            Flip the pieces and place the current player's piece, without changing the turn
+            */
+            void applyPlacement(Position position);
+
+            /*
+            Recompute the legal moves, piece counts and the end of the game from the pieces
+            and the turn, used after the board has been edited directly
+            */
+            void refreshState();
+
+            State m_state;
+
+            std::vector<HistoryEntry> m_history;
     };
 
+    typedef BasicOthello<6> Othello6;
+    typedef BasicOthello<8> Othello;
+    typedef BasicOthello<10> Othello10;
+
 }
@@ -1,4 +1,5 @@
 #include "Othello.hpp"
+#include "SharedCache.hpp"
 
 #pragma once
 
@@ -9,7 +10,11 @@ namespace othello {
         int score;
     };
 
-    class OthelloSolver : public Othello {
+    /*
+    The AI for a Size x Size board, the standard one is OthelloSolver, an alias of BasicOthelloSolver<8>
+    */
+    template<int Size>
+    class BasicOthelloSolver : public BasicOthello<Size> {
         public:
 
             /*
@@ -34,13 +39,25 @@ namespace othello {
             More spicifically alpha-beta pruning. prevLegalMoves is used only when the game
             has ended or the max depth has reached and is passed to the evaluate method
             */ 
-            Node miniMax(OthelloSolver board, int depth, int alpha, int beta, int prevLegalMoves=0);
+            Node miniMax(BasicOthelloSolver board, int depth, int alpha, int beta, int prevLegalMoves=0);
 
             /*
-            Finding the best node for the player
+            Finding the best node for the player. If a shared cache is set, a result that was
+            searched at least as deep is taken from it, and new results are added to it
             */ 
             Node solve(int depth, int lastMoves);
 
+            /*
+            Share the results of solve with every solver using the same cache, or stop sharing
+            them with nullptr. The cache has to outlive the solver
+            */
+            void setSharedCache(SharedCache* sharedCache);
+
+            /*
+            Get the shared cache, nullptr if there's none
+            */
+            SharedCache* getSharedCache() const;
+
             /*
             Make the best move availabe
             */ 
@@ -60,5 +77,23 @@ namespace othello {
                     return valueTwo;
                 }
             }
+
+        private:
+            /*
+            Get the two independent hashes of the position that identify it in the shared cache
+            */
+            void getCacheKeys(std::uint64_t& key, std::uint64_t& check) const;
+
+            /*
+            The search behind miniMax. Moves are made and undone on this board instead of
+            searching copies of it
+            */
+            Node search(int depth, int alpha, int beta, int prevLegalMoves);
+
+            SharedCache* m_sharedCache = nullptr;
     };
+
+    typedef BasicOthelloSolver<6> OthelloSolver6;
+    typedef BasicOthelloSolver<8> OthelloSolver;
+    typedef BasicOthelloSolver<10> OthelloSolver10;
 }
\ No newline at end of file
@@ -0,0 +1,138 @@
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#pragma once
+
+namespace othello {
+
+    /*
+    A search result as it's kept in the cache
+    */
+    struct CachedResult {
+        /*
+        The longest line of moves that's kept, the rest of a longer line is dropped
+        */
+        static const int MAX_LINE_LENGTH = 32;
+
+        int score;
+        // How many moves deep the result was searched, SharedCache::FULL_DEPTH if until the end
+        int depth;
+        int lineLength;
+        // The best line of moves as square indices (y*size + x), starting with the first move
+        std::uint8_t line[MAX_LINE_LENGTH];
+    };
+
+    /*
+    A table of search results in shared memory, so every process on the host that opens the
+    same name sees the same results. It's a POSIX shared memory object, which stays around
+    until it's removed even when no process has it open. On Windows it's a named file mapping,
+    which goes away with the last process that has it open.
+
+    Slots are never locked. Each has a version that's odd while it's being written, so a
+    reader that sees an odd or changed version treats the slot as a miss, and a writer that
+    finds a slot busy simply skips storing. A process that dies while writing leaves its slot
+    busy for good, since the cache outlives it; reset recovers such slots.
+    */
+    class SharedCache {
+        public:
+
+            /*
+            The depth of results that were searched until the end of the game
+            */
+            static const int FULL_DEPTH = 255;
+
+            /*
+            Opens the cache with the given name, creating it with slotCount slots if it doesn't
+            exist yet. An existing cache keeps its own slot count. Throws std::runtime_error
+            if the shared memory can't be opened or was made by another version
+            */
+            SharedCache(const std::string& name, int slotCount);
+
+            SharedCache(const SharedCache&) = delete;
+
+            SharedCache& operator=(const SharedCache&) = delete;
+
+            /*
+            Unmaps the cache, the results stay available to other and future processes
+            */
+            ~SharedCache();
+
+            /*
+            Look up a result. Returns false if there's none or the slot is being written
+            */
+            bool probe(std::uint64_t key, std::uint64_t check, CachedResult& result) const;
+
+            /*
+            Store a result, unless a deeper one for the same position is already there
+            */
+            void store(std::uint64_t key, std::uint64_t check, const CachedResult& result);
+
+            /*
+            Empty every slot that isn't being written at the moment
+            */
+            void clear();
+
+            /*
+            Empty every slot, including the ones left busy by processes that died while writing.
+            Only safe while no other process is storing into the cache
+            */
+            void reset();
+
+            /*
+            Get the amount of slots in the cache
+            */
+            int getSlotCount() const;
+
+            /*
+            Get the name the cache was opened with
+            */
+            std::string getName() const;
+
+            /*
+            Delete the shared memory with the given name. Processes that still have it open can
+            keep using it. Returns false if it doesn't exist
+            */
+            static bool remove(const std::string& name);
+
+        private:
+            /*
+            One cache line per slot
+            */
+            struct Slot {
+                std::atomic<std::uint64_t> version;
+                std::atomic<std::uint64_t> key;
+                std::atomic<std::uint64_t> check;
+                // The score in the low 32 bits, then 8 bits each of depth and line length
+                std::atomic<std::uint64_t> data;
+                std::atomic<std::uint64_t> line[CachedResult::MAX_LINE_LENGTH / 8];
+            };
+
+            struct Header {
+                // Set last by the process that creates the cache, once the rest is ready
+                std::atomic<std::uint64_t> magic;
+                std::uint64_t slotCount;
+                std::uint64_t padding[6];
+            };
+
+            static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                "Slots shared between processes need lock free 64 bit atomics");
+            static_assert(sizeof(Slot) == 64 && sizeof(Header) == 64,
+                "Header and slots should be one cache line each");
+
+            Slot& getSlot(std::uint64_t key) const;
+
+            void unmap();
+
+            std::string m_name;
+            void* m_memory;
+            std::size_t m_size;
+            Header* m_header;
+            Slot* m_slots;
+            std::uint64_t m_slotCount;
+#ifdef _WIN32
+            void* m_mapping;
+#endif
+    };
+
+}